@@ -0,0 +1,261 @@
+#include "konbu/konbu.h"
+#include "konbu/frozen.h"
+
+// i/o
+#include <iostream>
+#include <sstream>
+#include <yaml-cpp/yaml.h>
+
+// type constraints and algorithms
+#include <ranges>
+#include <algorithm>
+#include <numeric>
+#include <chrono>
+#include <thread>
+
+// data types and structures
+#include <unordered_map>
+#include <vector>
+#include <string>
+
+namespace ranges = std::ranges;
+namespace views = std::views;
+
+// Times parsing and reading the same generated document with each backend.
+// Build with CMAKE_BUILD_TYPE=Release for meaningful numbers.
+
+namespace bench {
+/** How an asset should be aligned */
+enum class alignment { start, center, end };
+
+/** A record exercising each of the core readers */
+struct record {
+    std::string name;
+    unsigned major_version = 0u;
+    unsigned minor_version = 0u;
+    alignment align = alignment::start;
+    unsigned flags = 0u;
+    int depth = 0;
+    std::vector<float> weights;
+};
+
+/** Maps alignment names to alignments */
+std::unordered_map<std::string, alignment> const alignment_names {
+    { "start",  alignment::start },
+    { "center", alignment::center },
+    { "end",    alignment::end }
+};
+
+/** Maps flag names to flags */
+std::unordered_map<std::string, unsigned> const flag_names {
+    { "visible",   1u << 0u },
+    { "focusable", 1u << 1u },
+    { "hidden",    1u << 2u }
+};
+
+/** Generate a yaml sequence of records, with every tenth record invalid */
+std::string generate_document(std::size_t num_records)
+{
+    std::stringstream document;
+    for (std::size_t i = 0; i < num_records; ++i) {
+        bool const invalid = i % 10 == 9;
+        document << "- name: widget-" << i << "\n"
+                 << "  version: \"1." << i % 7 << "\"\n"
+                 << "  align: " << (invalid ? "middle" : "center") << "\n"
+                 << "  flags: [visible, focusable]\n"
+                 << "  depth: " << (invalid ? "deep" : "3") << "\n"
+                 << "  weights: [1.5, 2, 0.25, " << i % 5 << "]\n";
+    }
+    return document.str();
+}
+
+/** Padding for a widget, read as a sequence "[left, right, top, bottom]" */
+struct padding {
+    float left = 0.f;
+    float right = 0.f;
+    float top = 0.f;
+    float bottom = 0.f;
+};
+
+/** Generate a yaml sequence of paddings, with every tenth padding invalid */
+std::string generate_paddings(std::size_t num_paddings)
+{
+    std::stringstream document;
+    for (std::size_t i = 0; i < num_paddings; ++i) {
+        bool const invalid = i % 10 == 9;
+        document << "- [" << i % 8 << ", " << (invalid ? "wide" : "2.5")
+                 << ", 1, " << i % 3 << "]\n";
+    }
+    return document.str();
+}
+
+// declared in the record's namespace so the generic sequence readers find it
+template<konbu::document_node config_node,
+         ranges::output_range<YAML::Exception> error_output>
+void read(config_node const & config, padding & value, error_output & errors)
+{
+    if (not config.IsSequence() or config.size() != 4) {
+        YAML::Exception const error{ config.Mark(),
+                                     "expecting 4 padding parameters" };
+        ranges::copy(views::single(error),
+                     konbu::back_inserter_preference(errors));
+        return;
+    }
+    konbu::read(config[0], value.left, errors);
+    konbu::read(config[1], value.right, errors);
+    konbu::read(config[2], value.top, errors);
+    konbu::read(config[3], value.bottom, errors);
+}
+
+/** Time a function, and report the average time per run in milliseconds */
+template<std::invocable function>
+void measure(std::string const & label, std::size_t num_runs, function && run)
+{
+    using clock = std::chrono::steady_clock;
+    auto const start = clock::now();
+    for (std::size_t i = 0; i < num_runs; ++i) {
+        run();
+    }
+    std::chrono::duration<double, std::milli> const elapsed =
+        clock::now() - start;
+    std::cout << label << ": " << elapsed.count() / num_runs << " ms\n";
+}
+}
+
+namespace konbu {
+template<konbu::document_node config_node,
+         ranges::output_range<YAML::Exception> error_output>
+void read(config_node const & config,
+          bench::record & record,
+          error_output & errors)
+{
+    if (not config.IsMap()) {
+        YAML::Exception const error{ config.Mark(), "expecting a map" };
+        ranges::copy(views::single(error), back_inserter_preference(errors));
+        return;
+    }
+    if (auto const name_config = config["name"]) {
+        konbu::read(name_config, record.name, errors);
+    }
+    if (auto const version_config = config["version"]) {
+        konbu::read_version(version_config, record.major_version,
+                            record.minor_version, errors);
+    }
+    if (auto const align_config = config["align"]) {
+        konbu::read_lookup(align_config, record.align, bench::alignment_names,
+                           errors);
+    }
+    if (auto const flags_config = config["flags"]) {
+        konbu::read_flags(flags_config, record.flags, bench::flag_names,
+                          errors);
+    }
+    if (auto const depth_config = config["depth"]) {
+        konbu::read(depth_config, record.depth, errors);
+    }
+    if (auto const weights_config = config["weights"]) {
+        konbu::partition_expect(weights_config, record.weights, errors);
+    }
+}
+}
+
+/** Read every record in a document, returning the number of errors */
+template<konbu::document_node config_node>
+std::size_t read_records(config_node const & document)
+{
+    std::vector<bench::record> records;
+    records.reserve(document.size());
+    std::vector<YAML::Exception> errors;
+    for (config_node const & node : document) {
+        konbu::read(node, records.emplace_back(), errors);
+    }
+    return errors.size();
+}
+
+/** Validate every record in a document, returning the number of errors */
+template<konbu::document_node config_node>
+std::size_t validate_records(config_node const & document)
+{
+    konbu::verdict checked;
+    for (config_node const & node : document) {
+        checked += konbu::validate<bench::record>(node);
+    }
+    return checked.num_errors;
+}
+
+/** Read the records of a frozen document, split across threads */
+std::size_t read_records_concurrently(konbu::frozen_node const & document,
+                                      std::size_t num_threads)
+{
+    std::vector<std::size_t> num_errors(num_threads, 0u);
+    {
+        std::vector<std::jthread> readers;
+        for (std::size_t t = 0; t < num_threads; ++t) {
+            readers.emplace_back([&document, &num_errors, num_threads, t] {
+                std::vector<bench::record> records;
+                std::vector<YAML::Exception> errors;
+                for (std::size_t i = t; i < document.size(); i += num_threads) {
+                    konbu::read(document[i], records.emplace_back(), errors);
+                }
+                num_errors[t] = errors.size();
+            });
+        }
+    }
+    return std::reduce(num_errors.begin(), num_errors.end());
+}
+
+int main(int argc, char * argv[])
+{
+    std::size_t const num_records = argc > 1? std::stoul(argv[1]) : 1000u;
+    std::size_t const num_runs = argc > 2? std::stoul(argv[2]) : 5u;
+    std::string const contents = bench::generate_document(num_records);
+    std::cout << num_records << " records, " << contents.size() << " bytes, "
+              << "average of " << num_runs << " runs\n";
+
+    bench::measure("yaml-cpp parse", num_runs, [&contents] {
+        YAML::Node const document = YAML::Load(contents);
+    });
+    YAML::Node const yaml_document = YAML::Load(contents);
+    bench::measure("yaml-cpp read", num_runs, [&yaml_document] {
+        read_records(yaml_document);
+    });
+    bench::measure("yaml-cpp validate", num_runs, [&yaml_document] {
+        validate_records(yaml_document);
+    });
+    bench::measure("frozen freeze", num_runs, [&yaml_document] {
+        konbu::frozen_document const document{ yaml_document };
+    });
+    konbu::frozen_document const frozen_document{ yaml_document };
+    bench::measure("frozen read", num_runs, [&frozen_document] {
+        read_records(frozen_document.root());
+    });
+    bench::measure("frozen validate", num_runs, [&frozen_document] {
+        validate_records(frozen_document.root());
+    });
+    std::size_t const num_threads =
+        std::max(std::thread::hardware_concurrency(), 1u);
+    bench::measure("frozen read, " + std::to_string(num_threads) + " threads",
+                   num_runs, [&frozen_document, num_threads] {
+        read_records_concurrently(frozen_document.root(), num_threads);
+    });
+    std::cout << read_records(yaml_document) << " errors per read, "
+              << validate_records(yaml_document) << " per validation\n";
+
+    // read paddings as an array of structs and as one column per field
+    YAML::Node const paddings = YAML::Load(bench::generate_paddings(num_records));
+    bench::measure("paddings as structs", num_runs, [&paddings] {
+        std::vector<bench::padding> values;
+        std::vector<YAML::Exception> errors;
+        konbu::partition_expect(paddings, values, errors);
+    });
+    bench::measure("paddings as columns", num_runs, [&paddings] {
+        std::vector<float> left, right, top, bottom;
+        std::vector<YAML::Exception> errors;
+        konbu::partition_columns(paddings, std::tuple{
+            konbu::column(&bench::padding::left, left),
+            konbu::column(&bench::padding::right, right),
+            konbu::column(&bench::padding::top, top),
+            konbu::column(&bench::padding::bottom, bottom)
+        }, errors);
+    });
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,10 @@
+// the widget schema and its readers
+#include "gold.h"
+#include "konbu/lint.h"
+
+int main(int argc, char * argv[])
+{
+    konbu::lint::linter lint;
+    lint.add_schema<gold::widget>("widget", "**.yaml");
+    return konbu::lint::run_command_line(lint, argc, argv);
+}
@@ -0,0 +1,381 @@
+#pragma once
+
+// konbu readers and the document node concept
+#include "konbu/konbu.h"
+
+// data types and structures
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// i/o
+#include <yaml-cpp/yaml.h>
+
+namespace konbu {
+
+class frozen_node;
+
+/**
+ * \brief An immutable snapshot of a yaml-cpp document
+ *
+ * Freezing copies the document into a contiguous node array. Scalars are
+ * interned into a single text buffer, and each map's keys are sorted once so
+ * that lookups are a hash of the key followed by a binary search.
+ *
+ * Nothing in a frozen document is modified after construction, so any number
+ * of threads may read from it at once without locking. The document must
+ * outlive any `frozen_node` taken from it.
+ *
+ * A frozen document can't be copied or moved: its scalar index holds views into
+ * its own text buffer, which a move could reallocate out from under them (e.g.
+ * a short text kept inline by the small string optimization). Keep it where it
+ * was constructed, or behind a `std::unique_ptr` to pass it around.
+ */
+class frozen_document {
+public:
+    /** The id of a node, scalar or child in the snapshot */
+    using index_type = std::uint32_t;
+
+    /** Marks a missing node or scalar */
+    static constexpr index_type none = std::numeric_limits<index_type>::max();
+
+    /** The kind of a frozen node */
+    enum class kind : std::uint8_t { null, scalar, sequence, map };
+
+    /** A node in the contiguous node array */
+    struct entry {
+        kind type = kind::null;
+        index_type scalar = none; /** interned scalar id */
+        index_type first = 0u;    /** offset of the first child */
+        index_type count = 0u;    /** number of children */
+        YAML::Mark mark;
+    };
+
+    /**
+     * \brief Freeze a yaml-cpp document
+     *
+     * Aliased sequences and maps are frozen once and shared by every node that
+     * refers to them.
+     *
+     * \param document  the loaded document to take a snapshot of
+     * \throws YAML::Exception if an alias refers to one of its own ancestors,
+     *         or if the document has 2^32 or more nodes, children or bytes of
+     *         scalar text
+     */
+    explicit frozen_document(YAML::Node const & document)
+    {
+        std::unordered_map<std::string, index_type> interned;
+        visit_map visited;
+        root_id = freeze(document, interned, visited);
+
+        // copy the interned scalars into one buffer, then index the buffer
+        std::vector<std::string const *> by_id(interned.size());
+        std::size_t text_size = 0u;
+        for (auto const & [scalar, id] : interned) {
+            by_id[id] = &scalar;
+            text_size += scalar.size();
+        }
+        // every offset into the text, including its end, must be an index
+        to_index(text_size);
+        text.reserve(text_size);
+        scalar_offsets.reserve(by_id.size() + 1u);
+        for (std::string const * scalar : by_id) {
+            scalar_offsets.push_back(static_cast<index_type>(text.size()));
+            text += *scalar;
+        }
+        scalar_offsets.push_back(static_cast<index_type>(text.size()));
+
+        scalar_ids.reserve(by_id.size());
+        for (index_type id = 0u; id < by_id.size(); ++id) {
+            scalar_ids.emplace(scalar(id), id);
+        }
+        // sort each map's lookup index by key id
+        for (entry const & node : nodes) {
+            if (node.type != kind::map) {
+                continue;
+            }
+            auto const begin = lookup.begin() + node.first;
+            std::ranges::sort(begin, begin + node.count, {},
+                              [this](index_type position) {
+                                  return keys[position];
+                              });
+        }
+    }
+    frozen_document(frozen_document const &) = delete;
+    frozen_document & operator=(frozen_document const &) = delete;
+
+    /** The root node of the document */
+    frozen_node root() const;
+
+    /** The node with the given id */
+    entry const & at(index_type id) const { return nodes[id]; }
+
+    /** The interned text of a scalar */
+    std::string_view scalar(index_type id) const
+    {
+        auto const offset = scalar_offsets[id];
+        return { text.data() + offset, scalar_offsets[id + 1u] - offset };
+    }
+
+    /** The node id of the child at a position in the child array */
+    index_type child(index_type position) const { return children[position]; }
+
+    /**
+     * \brief Find the value of a key in a map node
+     * \return the node id of the value, or `none` if the key isn't mapped
+     */
+    index_type find(entry const & map, std::string_view key) const
+    {
+        auto const search = scalar_ids.find(key);
+        if (search == scalar_ids.end()) {
+            return none;
+        }
+        index_type const key_id = search->second;
+        auto const begin = lookup.begin() + map.first;
+        auto const end = begin + map.count;
+        auto const found = std::ranges::lower_bound(
+            begin, end, key_id, {},
+            [this](index_type position) { return keys[position]; });
+
+        if (found == end or keys[*found] != key_id) {
+            return none;
+        }
+        return children[*found];
+    }
+private:
+    // a sequence or map that has been frozen or is being frozen, keyed by the
+    // position of its mark and compared by identity, since aliases share nodes
+    struct visit {
+        YAML::Node node;
+        index_type id;
+        bool complete;
+    };
+    using visit_map = std::unordered_multimap<int, visit>;
+
+    // narrow a size or offset to an index, which must stay below `none`
+    static index_type to_index(std::size_t size)
+    {
+        if (size >= none) {
+            throw YAML::Exception{ YAML::Mark::null_mark(),
+                                   "document is too large to freeze" };
+        }
+        return static_cast<index_type>(size);
+    }
+
+    index_type freeze(YAML::Node const & node,
+                      std::unordered_map<std::string, index_type> & interned,
+                      visit_map & visited)
+    {
+        auto intern = [&interned](std::string const & scalar) {
+            auto const next_id = to_index(interned.size());
+            return interned.try_emplace(scalar, next_id).first->second;
+        };
+        auto const id = to_index(nodes.size());
+        if (node.IsSequence() or node.IsMap()) {
+            auto const [first, last] = visited.equal_range(node.Mark().pos);
+            auto const previous = std::find_if(first, last,
+                [&node](auto const & seen) { return seen.second.node.is(node); });
+
+            if (previous != last) {
+                if (not previous->second.complete) {
+                    throw YAML::Exception{
+                        node.Mark(), "alias refers to one of its ancestors"
+                    };
+                }
+                return previous->second.id;
+            }
+        }
+        nodes.push_back(entry{ .mark = node.Mark() });
+
+        if (node.IsScalar()) {
+            nodes[id].type = kind::scalar;
+            nodes[id].scalar = intern(node.Scalar());
+            return id;
+        }
+        if (not node.IsSequence() and not node.IsMap()) {
+            return id;
+        }
+        // reserve a contiguous block of children before freezing them, since
+        // freezing a child appends its own children after this block
+        auto const first = to_index(children.size());
+        auto const count = to_index(node.size());
+        to_index(children.size() + node.size());
+        nodes[id].type = node.IsMap()? kind::map : kind::sequence;
+        nodes[id].first = first;
+        nodes[id].count = count;
+        children.resize(first + count, none);
+        keys.resize(first + count, none);
+        lookup.resize(first + count, none);
+        auto const current = visited.emplace(node.Mark().pos,
+                                             visit{ node, id, false });
+
+        index_type position = first;
+        for (auto const & child : node) {
+            if (node.IsMap()) {
+                if (child.first.IsScalar()) {
+                    keys[position] = intern(child.first.Scalar());
+                }
+                children[position] = freeze(child.second, interned, visited);
+            }
+            else {
+                children[position] = freeze(child, interned, visited);
+            }
+            lookup[position] = position;
+            ++position;
+        }
+        current->second.complete = true;
+        return id;
+    }
+
+    std::vector<entry> nodes;
+    index_type root_id = none;
+
+    // children of sequences and maps, in document order, with the key of each
+    // map child, and each map's child positions sorted by key
+    std::vector<index_type> children;
+    std::vector<index_type> keys;
+    std::vector<index_type> lookup;
+
+    // interned scalars
+    std::string text;
+    std::vector<index_type> scalar_offsets;
+    std::unordered_map<std::string_view, index_type> scalar_ids;
+};
+
+/**
+ * \brief A read-only handle to a node in a `frozen_document`
+ *
+ * Models `konbu::document_node` with the same semantics as a const
+ * `YAML::Node`: looking up a missing key or index gives an invalid node that
+ * converts to `false`. Iterating a map visits its values in document order.
+ */
+class frozen_node {
+public:
+    using index_type = frozen_document::index_type;
+    using kind = frozen_document::kind;
+
+    /** Iterates over the children of a sequence or map node */
+    class iterator {
+    public:
+        using value_type = frozen_node;
+        using difference_type = std::ptrdiff_t;
+
+        iterator() = default;
+        iterator(frozen_document const * document, index_type position)
+            : document{ document }, position{ position }
+        {
+        }
+        frozen_node operator*() const
+        {
+            return { document, document->child(position) };
+        }
+        iterator & operator++()
+        {
+            ++position;
+            return *this;
+        }
+        iterator operator++(int)
+        {
+            iterator const previous = *this;
+            ++*this;
+            return previous;
+        }
+        bool operator==(iterator const & other) const
+        {
+            return position == other.position;
+        }
+    private:
+        frozen_document const * document = nullptr;
+        index_type position = 0u;
+    };
+
+    frozen_node() = default;
+    frozen_node(frozen_document const * document, index_type id)
+        : document{ document }, id{ id }
+    {
+    }
+
+    explicit operator bool() const { return id != frozen_document::none; }
+
+    bool IsScalar() const { return is(kind::scalar); }
+    bool IsSequence() const { return is(kind::sequence); }
+    bool IsMap() const { return is(kind::map); }
+
+    std::string_view Scalar() const
+    {
+        if (not IsScalar()) {
+            return {};
+        }
+        return document->scalar(document->at(id).scalar);
+    }
+    YAML::Mark Mark() const
+    {
+        if (not *this) {
+            return YAML::Mark::null_mark();
+        }
+        return document->at(id).mark;
+    }
+    std::size_t size() const
+    {
+        if (not IsSequence() and not IsMap()) {
+            return 0u;
+        }
+        return document->at(id).count;
+    }
+
+    frozen_node operator[](std::string_view key) const
+    {
+        if (not IsMap()) {
+            return { document, frozen_document::none };
+        }
+        return { document, document->find(document->at(id), key) };
+    }
+    frozen_node operator[](std::size_t index) const
+    {
+        if (not IsSequence() or index >= size()) {
+            return { document, frozen_document::none };
+        }
+        auto const position = document->at(id).first + index;
+        return { document, document->child(static_cast<index_type>(position)) };
+    }
+
+    iterator begin() const
+    {
+        if (not IsSequence() and not IsMap()) {
+            return end();
+        }
+        return { document, document->at(id).first };
+    }
+    iterator end() const
+    {
+        if (not IsSequence() and not IsMap()) {
+            return { document, 0u };
+        }
+        auto const & node = document->at(id);
+        return { document, node.first + node.count };
+    }
+private:
+    bool is(kind type) const
+    {
+        return *this and document->at(id).type == type;
+    }
+
+    frozen_document const * document = nullptr;
+    index_type id = frozen_document::none;
+};
+
+inline frozen_node frozen_document::root() const
+{
+    return { this, root_id };
+}
+
+#ifdef KONBU_COMPILED_READERS
+KONBU_CORE_READERS(extern template, frozen_node)
+#endif
+}
@@ -3,6 +3,12 @@
 // data types and resource handles
 #include <optional>
 #include <expected>
+#include <memory>
+#include <array>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include <functional>
 
 // type constraints
 #include <concepts>
@@ -11,6 +17,8 @@
 // i/o
 #include <sstream>
 #include <regex>
+#include <charconv>
+#include <string_view>
 #include <yaml-cpp/yaml.h>
 
 namespace konbu {
@@ -78,6 +86,150 @@ auto back_inserter_preference(container & c)
     return std::front_inserter(c);
 }
 
+/**
+ * \brief A document node that konbu can read values from
+ * \tparam node  has scalar, sequence and map access, and can report its mark
+ *
+ * `YAML::Node` models this concept as-is, and is the default backend. Other
+ * backends (see `konbu/frozen.h`) provide a light-weight node handle with the
+ * same interface. `Scalar` may return anything viewable as a `string_view`, as
+ * long as the viewed characters outlive the node handle.
+ */
+template<typename node>
+concept document_node =
+std::copy_constructible<node> and
+requires(node const & n, std::string const & key, std::size_t index)
+{
+    { n.IsScalar() } -> std::convertible_to<bool>;
+    { n.IsSequence() } -> std::convertible_to<bool>;
+    { n.IsMap() } -> std::convertible_to<bool>;
+    { n.Scalar() } -> std::convertible_to<std::string_view>;
+    { n.Mark() } -> std::convertible_to<YAML::Mark>;
+    { n.size() } -> std::convertible_to<std::size_t>;
+    { n[key] } -> std::convertible_to<node>;
+    { n[index] } -> std::convertible_to<node>;
+    n.begin();
+    n.end();
+    static_cast<bool>(n);
+};
+
+namespace detail {
+/**
+ * \brief Convert the numeric prefix of a scalar to a number
+ *
+ * \param text   scalar text, already validated by the caller
+ * \param value  write the converted number to
+ *
+ * \return true if the number fits in `number`
+ */
+template<typename number>
+bool from_scalar(std::string_view text, number & value)
+{
+    number converted{};
+    auto const [end, status] = std::from_chars(text.data(),
+                                               text.data() + text.size(),
+                                               converted);
+    if (status != std::errc{}) {
+        return false;
+    }
+    value = converted;
+    return true;
+}
+
+/**
+ * \brief Check that a scalar is an integer that fits in `number`
+ *
+ * \param scalar_value  scalar text to check
+ * \param value         write the integer to, if the scalar is valid
+ *
+ * \return a description of the problem, or nullptr if the scalar is valid
+ */
+template<std::integral number>
+char const * scan_integer(std::string_view scalar_value, number & value)
+{
+    static std::regex const negative_pattern{ "^-" };
+    static std::regex const integer_pattern{ "-?[0-9]+[ \t]*" };
+
+    if (std::is_unsigned_v<number> and
+        std::regex_search(scalar_value.begin(), scalar_value.end(),
+                          negative_pattern)) {
+        return "expecting a non-negative integer";
+    }
+    if (not std::regex_match(scalar_value.begin(), scalar_value.end(),
+                             integer_pattern)) {
+        return "expecting an integer";
+    }
+    if (not from_scalar(scalar_value, value)) {
+        return "integer is out of range";
+    }
+    return nullptr;
+}
+
+/**
+ * \brief Check that a scalar is a number that fits in `number`
+ *
+ * \param scalar_value  scalar text to check
+ * \param value         write the number to, if the scalar is valid
+ *
+ * \return a description of the problem, or nullptr if the scalar is valid
+ */
+template<std::floating_point number>
+char const * scan_number(std::string_view scalar_value, number & value)
+{
+    static std::regex const integer_pattern{ "-?[0-9]+\\.?" };
+    static std::regex const decimal_pattern{ "-?\\.[0-9]+" };
+    static std::regex const real_pattern{ "-?[0-9]+\\.[0-9]+" };
+
+    auto matches = [&scalar_value](std::regex const & pattern) {
+        return std::regex_match(scalar_value.begin(), scalar_value.end(),
+                                pattern);
+    };
+    if (not matches(integer_pattern) and
+        not matches(decimal_pattern) and
+        not matches(real_pattern)) {
+        return "expecting a number";
+    }
+    if (not from_scalar(scalar_value, value)) {
+        return "number is out of range";
+    }
+    return nullptr;
+}
+
+/**
+ * \brief Check that a scalar is a "<major>.<minor>" version string
+ *
+ * \param version_string    scalar text to check
+ * \param major_version     write the major version to, if the scalar is valid
+ * \param minor_version     write the minor version to, if the scalar is valid
+ *
+ * \return a description of the problem, or nullptr if the scalar is valid
+ */
+template<std::unsigned_integral number>
+char const * scan_version(std::string_view version_string,
+                          number & major_version, number & minor_version)
+{
+    static std::regex const version_pattern{ "([0-9]+)\\.([0-9]+)" };
+    std::match_results<std::string_view::const_iterator> version_match;
+    if (not std::regex_search(version_string.begin(), version_string.end(),
+                              version_match, version_pattern) or
+        version_match.size() != 3) {
+        return "version string must have the form \"<major>.<minor>\"";
+    }
+    auto as_view = [](auto const & submatch) {
+        return std::string_view{ submatch.first, submatch.second };
+    };
+    number parsed_major = 0u;
+    number parsed_minor = 0u;
+    if (not from_scalar(as_view(version_match[1]), parsed_major) or
+        not from_scalar(as_view(version_match[2]), parsed_minor)) {
+        return "version number is out of range";
+    }
+    major_version = parsed_major;
+    minor_version = parsed_minor;
+    return nullptr;
+}
+}
+
 /** The key type of map-container */
 template<typename container>
 using lookup_key_t = typename container::key_type;
@@ -99,84 +251,242 @@ requires(container const & c, lookup_key_t<container> const & key)
     { c.find(key)->second } -> std::convertible_to<lookup_mapped_t<container>>;
 };
 
+/**
+ * \brief An error output that only counts the errors written to it
+ *
+ * Readers check a config the same way whether or not their errors are counted,
+ * but the core readers skip building error messages for an `error_count`.
+ */
+class error_count {
+public:
+    using value_type = YAML::Exception;
+
+    /** Counts every error assigned through it */
+    class iterator {
+    public:
+        using difference_type = std::ptrdiff_t;
+
+        /** Counts an error assigned to it, instead of storing it */
+        struct counter {
+            std::size_t * num_errors;
+            counter const & operator=(YAML::Exception const &) const
+            {
+                ++*num_errors;
+                return *this;
+            }
+        };
+
+        iterator() = default;
+        explicit iterator(std::size_t * num_errors) : num_errors{ num_errors }
+        {
+        }
+        counter operator*() const { return { num_errors }; }
+        iterator & operator++() { return *this; }
+        iterator operator++(int) { return *this; }
+    private:
+        std::size_t * num_errors = nullptr;
+    };
+
+    iterator begin() { return iterator{ &num_errors }; }
+    std::unreachable_sentinel_t end() const { return {}; }
+
+    /** Count an error */
+    void push_back(YAML::Exception const &) { ++num_errors; }
+
+    /** Count errors without building them */
+    void add(std::size_t count) { num_errors += count; }
+
+    /** The number of errors counted so far */
+    std::size_t size() const { return num_errors; }
+private:
+    std::size_t num_errors = 0u;
+};
+
+/**
+ * \brief A non-owning, type-erased reference to an error output
+ *
+ * Readers that take an `error_sink` are instantiated once per value type,
+ * rather than once for every kind of error container they're called with. The
+ * referenced container must outlive the sink.
+ */
+class error_sink {
+public:
+    using value_type = YAML::Exception;
+
+    /**
+     * \brief Refer to an error output
+     * \tparam error_output     allocator-aware container of yaml-exceptions
+     * \param errors    write errors to, following the back_inserter_preference
+     */
+    template<std::ranges::output_range<YAML::Exception> error_output>
+    error_sink(error_output & errors)
+        : output{ std::addressof(errors) },
+          write{ [](void * output, YAML::Exception const & error) {
+              auto & errors = *static_cast<error_output *>(output);
+              std::ranges::copy(std::views::single(error),
+                                back_inserter_preference(errors));
+          } }
+    {
+        if constexpr (std::same_as<error_output, error_count>) {
+            counted = std::addressof(errors);
+        }
+    }
+
+    /** True if the referenced output only counts errors */
+    bool counting() const { return counted != nullptr; }
+
+    /** Write an error to the referenced output */
+    void push_back(YAML::Exception const & error) const
+    {
+        write(output, error);
+    }
+
+    /** Write an error, or only count it if the output is an `error_count` */
+    void report(YAML::Mark const & mark, char const * message) const
+    {
+        if (counted) {
+            counted->add(1u);
+            return;
+        }
+        push_back({ mark, message });
+    }
+
+    /**
+     * \brief Write an error, only building its message if it's kept
+     * \param make_message  returns the error message
+     */
+    template<std::invocable make_message>
+    void report(YAML::Mark const & mark, make_message && message) const
+    {
+        if (counted) {
+            counted->add(1u);
+            return;
+        }
+        push_back({ mark, std::invoke(message) });
+    }
+
+    /** Count errors without building them, if the output only counts errors */
+    void count(std::size_t num_errors) const
+    {
+        if (counted) {
+            counted->add(num_errors);
+        }
+    }
+private:
+    void * output;
+    void (*write)(void *, YAML::Exception const &);
+    error_count * counted = nullptr;
+};
+
+/**
+ * \brief The container generic readers collect the errors of each element in
+ *
+ * Generic readers call `read` unqualified with an `error_list`. Since it's a
+ * konbu type, argument-dependent lookup then searches namespace konbu as well
+ * as the namespace of the value type, so overloads declared in either place
+ * after this header are found, whatever the document backend.
+ */
+class error_list : public std::vector<YAML::Exception> {
+public:
+    using std::vector<YAML::Exception>::vector;
+};
+
 /**
  * \brief parse an arbitrary type from a name-lookup
  *
  * \tparam name_lookup      maps strings to value types
- * \tparam error_output     allocator-aware container of yaml-exceptions
  *
  * \param config    YAML string input
  * \param value     write parsed value to
  * \param lookup    maps names to their desired values
  * \param errors    write any parsing errors to
  */
-template<lookup_table name_lookup,
-         std::ranges::output_range<YAML::Exception> error_output>
+template<document_node config_node, lookup_table name_lookup>
 requires std::convertible_to<std::string, lookup_key_t<name_lookup>>
 
-void read_lookup(YAML::Node const & config,
+void read_lookup(config_node const & config,
                  lookup_mapped_t<name_lookup> & value,
                  name_lookup const & lookup,
-                 error_output & errors)
+                 error_sink errors)
 {
-    namespace ranges = std::ranges;
     namespace views = std::views;
     if (not config.IsScalar()) {
-        YAML::Exception const error{ config.Mark(), "expecting a string" };
-        ranges::copy(views::single(error),
-                     back_inserter_preference(errors));
+        errors.report(config.Mark(), "expecting a string");
         return;
     }
-    auto const search = lookup.find(config.as<std::string>());
+    std::string const key{ std::string_view{ config.Scalar() } };
+    auto const search = lookup.find(key);
     if (search != lookup.end()) {
         value = search->second;
         return;
     }
-    std::stringstream message;
-    message << "expecting value to be one of the following: [";
-    std::string sep;
-    for (const auto & name : lookup | views::keys) {
-        message << sep << name;
-        sep = ", ";
-    }
-    message << "]";
-    YAML::Exception const error{ config.Mark(), message.str() };
-    ranges::copy(views::single(error),
-                 back_inserter_preference(errors));
+    errors.report(config.Mark(), [&lookup] {
+        std::stringstream message;
+        message << "expecting value to be one of the following: [";
+        std::string sep;
+        for (const auto & name : lookup | views::keys) {
+            message << sep << name;
+            sep = ", ";
+        }
+        message << "]";
+        return message.str();
+    });
+}
+
+/**
+ * \brief parse an arbitrary type from a name-lookup
+ * \tparam error_output     allocator-aware container of yaml-exceptions
+ */
+template<document_node config_node,
+         lookup_table name_lookup,
+         std::ranges::output_range<YAML::Exception> error_output>
+requires std::convertible_to<std::string, lookup_key_t<name_lookup>>
+
+void read_lookup(config_node const & config,
+                 lookup_mapped_t<name_lookup> & value,
+                 name_lookup const & lookup,
+                 error_output & errors)
+{
+    read_lookup(config, value, lookup, error_sink{ errors });
 }
 
 /**
  * \brief Read a string value from config
  *
  * \tparam string_like      can be converted to a string
- * \tparam error_output     an allocator-aware container of yaml-exceptions
  *
  * \param config    YAML string input
  * \param value     write the parsed string to
  * \param errors    write any parsing errors to
  */
-template<typename string_like,
-         std::ranges::output_range<YAML::Exception> error_output>
+template<document_node config_node, typename string_like>
 requires std::convertible_to<std::string, string_like>
-void read(YAML::Node const & config, string_like & value, error_output & errors)
+void read(config_node const & config, string_like & value, error_sink errors)
 {
-    namespace ranges = std::ranges;
-    namespace views = std::views;
-
     if (not config.IsScalar()) {
-        YAML::Exception const error{ config.Mark(), "expecting a string" };
-        ranges::copy(views::single(error),
-                     back_inserter_preference(errors));
+        errors.report(config.Mark(), "expecting a string");
         return;
     }
-    value = config.Scalar();
+    value = std::string{ std::string_view{ config.Scalar() } };
+}
+
+/**
+ * \brief Read a string value from config
+ * \tparam error_output     an allocator-aware container of yaml-exceptions
+ */
+template<document_node config_node,
+         typename string_like,
+         std::ranges::output_range<YAML::Exception> error_output>
+requires std::convertible_to<std::string, string_like>
+void read(config_node const & config, string_like & value, error_output & errors)
+{
+    read(config, value, error_sink{ errors });
 }
 
 /**
  * \brief Read an integer point number from config
  *
  * \tparam number           integer type
- * \tparam error_output     allocator-aware range of yaml-exceptions
  *
  * \param config    YAML integer input
  * \param value     write parsed integer to
@@ -185,94 +495,83 @@ void read(YAML::Node const & config, string_like & value, error_output & errors)
  * \note Reading a negative number from `config` for an unsigned `number` type
  *       will result in an error written to `errors`.
  */
-template<std::integral number,
-         std::ranges::output_range<YAML::Exception> error_output>
-void read(YAML::Node const & config, number & value, error_output & errors)
+template<document_node config_node, std::integral number>
+void read(config_node const & config, number & value, error_sink errors)
 {
-    namespace ranges = std::ranges;
-    namespace views = std::views;
-
     if (not config.IsScalar()) {
-        YAML::Exception const error{ config.Mark(), "expecting an integer" };
-        ranges::copy(views::single(error),
-                     back_inserter_preference(errors));
-        return;
-    }
-    std::regex const negative_pattern{ "^-" };
-    if (std::is_unsigned_v<number> and
-        std::regex_search(config.Scalar(), negative_pattern)) {
-
-        YAML::Exception const error{ config.Mark(),
-                                     "expecting a non-negative integer" };
-        ranges::copy(views::single(error),
-                     back_inserter_preference(errors));
+        errors.report(config.Mark(), "expecting an integer");
         return;
     }
-    std::regex const integer_pattern{ "-?[0-9]+[ \t]*" };
-    if (not std::regex_match(config.Scalar(), integer_pattern)) {
-        YAML::Exception const error{ config.Mark(), "expecting an integer" };
-        ranges::copy(views::single(error),
-                     back_inserter_preference(errors));
-        return;
+    if (auto const problem = detail::scan_integer(config.Scalar(), value)) {
+        errors.report(config.Mark(), problem);
     }
-    value = config.as<number>();
+}
+
+/**
+ * \brief Read an integer point number from config
+ * \tparam error_output     allocator-aware range of yaml-exceptions
+ */
+template<document_node config_node,
+         std::integral number,
+         std::ranges::output_range<YAML::Exception> error_output>
+void read(config_node const & config, number & value, error_output & errors)
+{
+    read(config, value, error_sink{ errors });
 }
 
 /**
  * \brief Read a floating point number from config
  *
  * \tparam number           floating-point type
- * \tparam error_output     allocator aware container of yaml-exceptions
  *
  * \param config    YAML floating point input
  * \param value     write parsed number to
  * \param errors    write any parsing errors to
  */
-template<std::floating_point number,
-         std::ranges::output_range<YAML::Exception> error_output>
-void read(YAML::Node const & config, number & value, error_output & errors)
+template<document_node config_node, std::floating_point number>
+void read(config_node const & config, number & value, error_sink errors)
 {
-    namespace ranges = std::ranges;
-    namespace views = std::views;
     if (not config.IsScalar()) {
-        YAML::Exception const error{ config.Mark(), "expecting a number" };
-        ranges::copy(views::single(error),
-                     back_inserter_preference(errors));
+        errors.report(config.Mark(), "expecting a number");
         return;
     }
-    std::regex const integer_pattern{ "-?[0-9]+\\.?" };
-    std::regex const decimal_pattern{ "-?\\.[0-9]+" };
-    std::regex const real_pattern{ "-?[0-9]+\\.[0-9]+" };
-
-    std::string const& scalar_value = config.Scalar();
-    if (not std::regex_match(scalar_value, integer_pattern) and
-        not std::regex_match(scalar_value, decimal_pattern) and
-        not std::regex_match(scalar_value, real_pattern)) {
-
-        YAML::Exception const error{ config.Mark(), "expecting a number" };
-        ranges::copy(views::single(error),
-                     back_inserter_preference(errors));
-        return;
+    if (auto const problem = detail::scan_number(config.Scalar(), value)) {
+        errors.report(config.Mark(), problem);
     }
-    value = config.as<number>();
+}
+
+/**
+ * \brief Read a floating point number from config
+ * \tparam error_output     allocator aware container of yaml-exceptions
+ */
+template<document_node config_node,
+         std::floating_point number,
+         std::ranges::output_range<YAML::Exception> error_output>
+void read(config_node const & config, number & value, error_output & errors)
+{
+    read(config, value, error_sink{ errors });
 }
 
 /**
  * \brief Models a type that can be read by the konbu read interface
- * \tparam value the value-type to read
+ * \tparam value        the value-type to read
+ * \tparam config_node  the document backend to read from
+ *
+ * `read` is looked up unqualified with an `error_list`, so overloads declared
+ * in namespace konbu or in the namespace of `value` are both found by
+ * argument-dependent lookup, even when they're declared after this header.
  */
-template<typename value>
+template<typename value, typename config_node = YAML::Node>
 concept readable =
-requires(YAML::Node const & node, value & v, std::vector<YAML::Exception> & errors)
+requires(config_node const & node, value & v, error_list & errors)
 {
-    konbu::read(node, v, errors);
+    read(node, v, errors);
 };
 
 /**
  * \brief Parse a sequence of values
  *
  * \tparam value_output     allocator-aware container of konbu-readable types
- * \tparam error_output     allocator-aware container of yaml-exceptions
  *
  * \param sequence  YAML sequence input of desired values
  * \param values    write parsed values to
@@ -282,28 +581,26 @@ requires(YAML::Node const & node, value & v, std::vector<YAML::Exception> & erro
  * config values that fail to parse won't be written to `values`, and the error
  * will be written to `errors`
  */
-template<std::ranges::range value_output,
-         std::ranges::output_range<YAML::Exception> error_output>
-requires readable<std::ranges::range_value_t<value_output>>
+template<document_node config_node, std::ranges::range value_output>
+requires readable<std::ranges::range_value_t<value_output>, config_node>
 
-void partition_expect(YAML::Node const & sequence,
+void partition_expect(config_node const & sequence,
                       value_output & values,
-                      error_output & errors)
+                      error_sink errors)
 {
     namespace ranges = std::ranges;
     namespace views = std::views;
     using value_t = ranges::range_value_t<value_output>;
 
     if (not sequence.IsSequence()) {
-        YAML::Exception const error{ sequence.Mark(), "expecting a sequence" };
-        ranges::copy(views::single(error), back_inserter_preference(errors));
+        errors.report(sequence.Mark(), "expecting a sequence");
         return;
     }
-    std::vector<YAML::Exception> sequence_errors;
-    for (YAML::Node const & node : sequence) {
+    error_list sequence_errors;
+    for (config_node const & node : sequence) {
         value_t value;
         auto const num_errors = sequence_errors.size();
-        konbu::read(node, value, sequence_errors);
+        read(node, value, sequence_errors);
 
         if (sequence_errors.size() != num_errors) {
             continue;
@@ -311,20 +608,189 @@ void partition_expect(YAML::Node const & sequence,
         ranges::copy(views::single(value),
                      back_inserter_preference(values));
     }
+    // errors that are only counted don't need to be contextualized
+    if (errors.counting()) {
+        errors.count(sequence_errors.size());
+        return;
+    }
+    auto contextualize = [](YAML::Exception const & error) {
+        std::stringstream message;
+        message << "couldn't read sequence value: " << error.msg;
+        return YAML::Exception{ error.mark, message.str() };
+    };
+    ranges::copy(sequence_errors | views::transform(contextualize),
+                 std::back_inserter(errors));
+}
+
+/**
+ * \brief Parse a sequence of values
+ * \tparam error_output     allocator-aware container of yaml-exceptions
+ */
+template<document_node config_node,
+         std::ranges::range value_output,
+         std::ranges::output_range<YAML::Exception> error_output>
+requires readable<std::ranges::range_value_t<value_output>, config_node>
+
+void partition_expect(config_node const & sequence,
+                      value_output & values,
+                      error_output & errors)
+{
+    partition_expect(sequence, values, error_sink{ errors });
+}
+
+/**
+ * \brief A container that can be used as a column of record fields
+ * \tparam container    a resizable, contiguous container
+ */
+template<typename container>
+concept resizable_column =
+std::ranges::contiguous_range<container> and
+requires(container & c, std::size_t size)
+{
+    c.resize(size);
+};
+
+/**
+ * \brief Describes a column to read one field of a record into
+ *
+ * \tparam record           the record type that's read from each sequence value
+ * \tparam field            the type of the record's field
+ * \tparam column_output    resizable, contiguous container of field values
+ */
+template<typename record, typename field, resizable_column column_output>
+requires std::assignable_from<std::ranges::range_reference_t<column_output>,
+                              field &&>
+struct record_column {
+    field record::* member;
+    column_output & values;
+};
+
+/**
+ * \brief Describe a column to read a record field into
+ *
+ * \param member    the field of the record to read into the column
+ * \param values    write each valid record's field to
+ */
+template<typename record, typename field, resizable_column column_output>
+requires std::assignable_from<std::ranges::range_reference_t<column_output>,
+                              field &&>
+auto column(field record::* member, column_output & values)
+{
+    return record_column<record, field, column_output>{ member, values };
+}
+
+/**
+ * \brief Parse a sequence of records into one column per field
+ *
+ * \tparam record   a default-constructible, konbu-readable type
+ *
+ * \param sequence  YAML sequence input of desired records
+ * \param columns   describes which record field is written to which column
+ * \param errors    write any parsing errors to
+ *
+ * Each value in the sequence is read as a `record`, exactly like
+ * `partition_expect`, and each described field of a valid record is appended
+ * to its column. Records that fail to parse aren't written to any column, so
+ * the columns stay aligned row by row. The columns are sized once for the whole
+ * sequence up-front, and trimmed to the number of valid records afterwards, even
+ * if resizing a column or reading a record throws.
+ */
+template<document_node config_node,
+         std::default_initializable record,
+         typename... fields,
+         resizable_column... column_outputs>
+requires readable<record, config_node>
+
+void partition_columns(
+    config_node const & sequence,
+    std::tuple<record_column<record, fields, column_outputs>...> const & columns,
+    error_sink errors)
+{
+    namespace ranges = std::ranges;
+    namespace views = std::views;
+
+    if (not sequence.IsSequence()) {
+        errors.report(sequence.Mark(), "expecting a sequence");
+        return;
+    }
+    // every column may already hold values, so remember where each one starts
+    std::array<std::size_t, sizeof...(fields)> offsets{};
+    auto for_each_column = [&columns](auto && apply) {
+        [&]<std::size_t... i>(std::index_sequence<i...>) {
+            (apply(std::get<i>(columns), i), ...);
+        }(std::index_sequence_for<fields...>{});
+    };
+    for_each_column([&offsets](auto const & column, std::size_t i) {
+        offsets[i] = ranges::size(column.values);
+    });
+    std::size_t num_valid = 0u;
+    auto trim = [&for_each_column, &offsets, &num_valid] {
+        for_each_column([&offsets, num_valid](auto const & column,
+                                              std::size_t i) {
+            column.values.resize(offsets[i] + num_valid);
+        });
+    };
+    error_list sequence_errors;
+    try {
+        std::size_t const num_rows = sequence.size();
+        for_each_column([&offsets, num_rows](auto const & column,
+                                             std::size_t i) {
+            column.values.resize(offsets[i] + num_rows);
+        });
+        for (config_node const & node : sequence) {
+            record value;
+            auto const num_errors = sequence_errors.size();
+            read(node, value, sequence_errors);
+
+            if (sequence_errors.size() != num_errors) {
+                continue;
+            }
+            for_each_column([&](auto const & column, std::size_t i) {
+                ranges::begin(column.values)[offsets[i] + num_valid] =
+                    std::move(value.*column.member);
+            });
+            ++num_valid;
+        }
+    }
+    // don't leave default values in the columns if resizing a column or
+    // reading a record throws
+    catch (...) {
+        trim();
+        throw;
+    }
+    trim();
     auto contextualize = [](YAML::Exception const & error) {
         std::stringstream message;
         message << "couldn't read sequence value: " << error.msg;
         return YAML::Exception{ error.mark, message.str() };
     };
     ranges::copy(sequence_errors | views::transform(contextualize),
-                 back_inserter_preference(errors));
+                 std::back_inserter(errors));
+}
+
+/**
+ * \brief Parse a sequence of records into one column per field
+ * \tparam error_output     allocator-aware container of yaml-exceptions
+ */
+template<document_node config_node,
+         std::default_initializable record,
+         typename... fields,
+         resizable_column... column_outputs,
+         std::ranges::output_range<YAML::Exception> error_output>
+requires readable<record, config_node>
+
+void partition_columns(
+    config_node const & sequence,
+    std::tuple<record_column<record, fields, column_outputs>...> const & columns,
+    error_output & errors)
+{
+    partition_columns(sequence, columns, error_sink{ errors });
 }
 
 /**
  * \brief Read flag values from a config node.
  *
  * \tparam flag_lookup          maps strings to flag-types
- * \tparam error_output         allocator-aware container of yaml-exceptions
  *
  * \param flagname_sequence     YAML input sequence of desired values
  * \param flags                 write parsed flags to
@@ -336,71 +802,69 @@ void partition_expect(YAML::Node const & sequence,
  * If no valid flags were parsed, the value existing in flags will be used.
  * Any invalid flagnames or other parsing errors will be written to `errors`
  */
-template<lookup_table flag_lookup,
-         std::ranges::output_range<YAML::Exception> error_output>
+template<document_node config_node, lookup_table flag_lookup>
 requires std::convertible_to<std::string, lookup_key_t<flag_lookup>> and
          std::unsigned_integral<lookup_mapped_t<flag_lookup>>
 
-void read_flags(YAML::Node const & flagname_sequence,
+void read_flags(config_node const & flagname_sequence,
                 lookup_mapped_t<flag_lookup> & flags,
                 flag_lookup const & lookup,
-                error_output & errors)
+                error_sink errors)
 {
-    namespace ranges = std::ranges;
     namespace views = std::views;
 
     if (not flagname_sequence.IsSequence()) {
-        YAML::Exception const error{ flagname_sequence.Mark(),
-                                     "expecting a sequence" };
-        ranges::copy(views::single(error), back_inserter_preference(errors));
+        errors.report(flagname_sequence.Mark(), "expecting a sequence");
         return;
     }
     lookup_mapped_t<flag_lookup> parsed_flags = 0u;
-    auto parse_valid = [&lookup, &parsed_flags](std::string const & name) {
+    for (config_node const & node : flagname_sequence) {
+        if (not node.IsScalar()) {
+            errors.report(node.Mark(),
+                          "couldn't parse flag: expecting a string");
+            continue;
+        }
+        std::string const name{ std::string_view{ node.Scalar() } };
         auto const search = lookup.find(name);
         if (search != lookup.end()) {
             parsed_flags |= search->second;
-            return true;
-        }
-        return false;
-    };
-    // partition algorithm
-    std::vector<YAML::Exception> flagname_errors;
-    for (YAML::Node const & node : flagname_sequence) {
-
-        std::string name;
-        auto const num_errors = flagname_errors.size();
-        konbu::read(node, name, flagname_errors);
-
-        if (flagname_errors.size() != num_errors) {
-            continue;
-        }
-        if (parse_valid(name)) {
             continue;
         }
-        std::stringstream message;
-        message << "no flag named \"" << name << "\"\n  "
-                << "expecting name to be one of the following: [";
-        std::string sep;
-        for (const auto & flag : lookup | views::keys) {
-            message << sep << flag;
-            sep = ", ";
-        }
-        message << "]";
-        YAML::Exception const error{ node.Mark(), message.str() };
-        ranges::copy(views::single(error),
-                     back_inserter_preference(flagname_errors));
+        errors.report(node.Mark(), [&lookup, &name] {
+            std::stringstream message;
+            message << "couldn't parse flag: "
+                    << "no flag named \"" << name << "\"\n  "
+                    << "expecting name to be one of the following: [";
+            std::string sep;
+            for (const auto & flag : lookup | views::keys) {
+                message << sep << flag;
+                sep = ", ";
+            }
+            message << "]";
+            return message.str();
+        });
     }
     if (parsed_flags != 0u) {
         flags = parsed_flags;
     }
-    auto contextualize = [](YAML::Exception const & error) {
-        std::stringstream message;
-        message << "couldn't parse flag: " << error.msg;
-        return YAML::Exception{ error.mark, message.str() };
-    };
-    ranges::copy(flagname_errors | views::transform(contextualize),
-                 back_inserter_preference(errors));
+}
+
+/**
+ * \brief Read flag values from a config node.
+ * \tparam error_output         allocator-aware container of yaml-exceptions
+ */
+template<document_node config_node,
+         lookup_table flag_lookup,
+         std::ranges::output_range<YAML::Exception> error_output>
+requires std::convertible_to<std::string, lookup_key_t<flag_lookup>> and
+         std::unsigned_integral<lookup_mapped_t<flag_lookup>>
+
+void read_flags(config_node const & flagname_sequence,
+                lookup_mapped_t<flag_lookup> & flags,
+                flag_lookup const & lookup,
+                error_output & errors)
+{
+    read_flags(flagname_sequence, flags, lookup, error_sink{ errors });
 }
 
 template<typename value>
@@ -446,52 +910,218 @@ inline auto contextualize_setting(std::string const & setting_name)
     };
 }
 
+
 /**
  * \brief read a simple version string
  *
  * \tparam number           non-negative integer
- * \tparam error_output     allocator-aware container of yaml-exceptions
  *
  * \param input             yaml input for version string
  * \param major_version     write major version to
  * \param minor_version     write minor version to
  * \param errors            write any parsing errors to
  */
-template<std::unsigned_integral number,
-    std::ranges::output_range<YAML::Exception> error_output>
-void read_version(YAML::Node const & input,
+template<document_node config_node, std::unsigned_integral number>
+void read_version(config_node const & input,
                   number & major_version, number & minor_version,
-                  error_output & errors)
+                  error_sink errors)
 {
-    namespace ranges = std::ranges;
-    namespace views = std::views;
     if (not input.IsScalar()) {
-        YAML::Exception const error{ input.Mark(),
-                                     "expecting a version string" };
-        ranges::copy(views::single(error),
-                     back_inserter_preference(errors));
+        errors.report(input.Mark(), "expecting a version string");
         return;
     }
-    YAML::Exception const format_error{
-        input.Mark(),
-        "version string must have the form \"<major>.<minor>\""
-    };
-    std::regex const version_pattern{ "([0-9]+)\\.([0-9]+)" };
-    std::smatch version_match;
-    if (not std::regex_search(input.Scalar(), version_match, version_pattern)) {
-        ranges::copy(views::single(format_error),
-                     back_inserter_preference(errors));
-        return;
+    if (auto const problem = detail::scan_version(input.Scalar(),
+                                                  major_version,
+                                                  minor_version)) {
+        errors.report(input.Mark(), problem);
     }
-    if (version_match.size() != 3) {
-        ranges::copy(views::single(format_error),
-                     back_inserter_preference(errors));
-        return;
+}
+
+/**
+ * \brief read a simple version string
+ * \tparam error_output     allocator-aware container of yaml-exceptions
+ */
+template<document_node config_node,
+         std::unsigned_integral number,
+         std::ranges::output_range<YAML::Exception> error_output>
+void read_version(config_node const & input,
+                  number & major_version, number & minor_version,
+                  error_output & errors)
+{
+    read_version(input, major_version, minor_version, error_sink{ errors });
+}
+
+/**
+ * \brief The outcome of validating a config without reading its values
+ */
+struct verdict {
+    /** the number of errors that reading the config would write */
+    std::size_t num_errors = 0u;
+
+    /** true if the config would read without any errors */
+    explicit operator bool() const { return num_errors == 0u; }
+
+    verdict & operator+=(verdict const & other)
+    {
+        num_errors += other.num_errors;
+        return *this;
+    }
+};
+
+namespace detail {
+/**
+ * \brief Read a value, counting its errors
+ *
+ * Readers that accept an `error_count` are given one directly. Readers that
+ * only accept an error container write into an `error_list`, which is counted.
+ */
+template<typename value, document_node config_node>
+void count_errors(config_node const & config, value & read_value,
+                  error_count & errors)
+{
+    if constexpr (requires { read(config, read_value, errors); }) {
+        read(config, read_value, errors);
+    }
+    else {
+        error_list listed;
+        read(config, read_value, listed);
+        errors.add(listed.size());
+    }
+}
+}
+
+/**
+ * \brief Check that a value would read from config without any errors
+ *
+ * \tparam value    a default-constructible, konbu-readable type
+ *
+ * \param config    YAML input for the value
+ *
+ * \return the number of errors that `read` would write
+ *
+ * The value is read into a discarded value with an `error_count`, so any `read`
+ * overload can be validated, and the core readers skip building error messages.
+ * Overloads that only accept an error container are read into an `error_list`.
+ */
+template<typename value, document_node config_node>
+verdict validate(config_node const & config)
+{
+    value discarded{};
+    error_count errors;
+    detail::count_errors(config, discarded, errors);
+    return { errors.size() };
+}
+
+/**
+ * \brief Check that a name-lookup would read from config without any errors
+ *
+ * \param config    YAML string input
+ * \param lookup    maps names to their desired values
+ *
+ * \return the number of errors that `read_lookup` would write
+ */
+template<document_node config_node, lookup_table name_lookup>
+requires std::convertible_to<std::string, lookup_key_t<name_lookup>>
+
+verdict validate_lookup(config_node const & config, name_lookup const & lookup)
+{
+    lookup_mapped_t<name_lookup> discarded{};
+    error_count errors;
+    read_lookup(config, discarded, lookup, errors);
+    return { errors.size() };
+}
+
+/**
+ * \brief Check that a sequence of values would read without any errors
+ *
+ * \tparam value    a default-constructible, konbu-readable type
+ *
+ * \param sequence  YAML sequence input of values
+ *
+ * \return the number of errors that `partition_expect` or `partition_columns`
+ *         would write
+ *
+ * Each value is read into a discarded local, so no sequence of values is built.
+ */
+template<typename value, document_node config_node>
+verdict validate_sequence(config_node const & sequence)
+{
+    if (not sequence.IsSequence()) {
+        return { 1u };
+    }
+    error_count errors;
+    for (config_node const & node : sequence) {
+        value discarded{};
+        detail::count_errors(node, discarded, errors);
     }
-    YAML::Node const major_config{ version_match[1].str() };
-    major_version = major_config.as<number>();
+    return { errors.size() };
+}
+
+/**
+ * \brief Check that flag values would read without any errors
+ *
+ * \param flagname_sequence     YAML input sequence of flag names
+ * \param lookup                mapping of flag names to their int-values
+ *
+ * \return the number of errors that `read_flags` would write
+ */
+template<document_node config_node, lookup_table flag_lookup>
+requires std::convertible_to<std::string, lookup_key_t<flag_lookup>> and
+         std::unsigned_integral<lookup_mapped_t<flag_lookup>>
+
+verdict validate_flags(config_node const & flagname_sequence,
+                       flag_lookup const & lookup)
+{
+    lookup_mapped_t<flag_lookup> discarded = 0u;
+    error_count errors;
+    read_flags(flagname_sequence, discarded, lookup, errors);
+    return { errors.size() };
+}
+
+/**
+ * \brief Check that a version string would read without any errors
+ *
+ * \tparam number   non-negative integer
+ *
+ * \param input     yaml input for version string
+ *
+ * \return the number of errors that `read_version` would write
+ */
+template<std::unsigned_integral number, document_node config_node>
+verdict validate_version(config_node const & input)
+{
+    number major_version = 0u;
+    number minor_version = 0u;
+    error_count errors;
+    read_version(input, major_version, minor_version, errors);
+    return { errors.size() };
+}
+
+/**
+ * \brief Declare or define the explicit instantiations of the core readers
+ *
+ * \param prefix        `extern template` to declare, or `template` to define
+ * \param config_node   the document backend to instantiate the readers for
+ */
+#define KONBU_CORE_READERS(prefix, config_node)                                 \
+prefix void read(config_node const &, std::string &, error_sink);               \
+prefix void read(config_node const &, short &, error_sink);                     \
+prefix void read(config_node const &, int &, error_sink);                       \
+prefix void read(config_node const &, long &, error_sink);                      \
+prefix void read(config_node const &, long long &, error_sink);                 \
+prefix void read(config_node const &, unsigned short &, error_sink);            \
+prefix void read(config_node const &, unsigned &, error_sink);                  \
+prefix void read(config_node const &, unsigned long &, error_sink);             \
+prefix void read(config_node const &, unsigned long long &, error_sink);        \
+prefix void read(config_node const &, float &, error_sink);                     \
+prefix void read(config_node const &, double &, error_sink);                    \
+prefix void read_version(config_node const &, unsigned &, unsigned &,           \
+                         error_sink);                                           \
+prefix void read_version(config_node const &, unsigned long &, unsigned long &, \
+                         error_sink);
 
-    YAML::Node const minor_config{ version_match[2].str() };
-    minor_version = minor_config.as<number>();
+// the core readers are compiled once into the konbu-readers library
+#ifdef KONBU_COMPILED_READERS
+KONBU_CORE_READERS(extern template, YAML::Node)
+#endif
 }
-}
\ No newline at end of file
@@ -0,0 +1,647 @@
+#pragma once
+
+// konbu readers
+#include "konbu/konbu.h"
+
+// data types and structures
+#include <atomic>
+#include <charconv>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <random>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// i/o
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <yaml-cpp/yaml.h>
+
+/**
+ * Validate trees of yaml assets against konbu readers, in parallel.
+ *
+ * Each schema is a readable type registered against a path glob. A file is
+ * validated by reading it into a default-constructed value of the first schema
+ * whose glob matches its path relative to the current directory, and collecting
+ * the errors. Results are cached on disk by path, content hash and schema name,
+ * so unchanged files are only hashed on later runs of the same build.
+ *
+ * Like the generic readers, schemas look `read` up unqualified with an
+ * `error_list`, so overloads in namespace konbu and in the namespace of the
+ * schema type are both found.
+ */
+namespace konbu::lint {
+
+/** An error found while validating a file */
+struct finding {
+    YAML::Mark mark;
+    std::string message;
+};
+
+/** The outcome of validating one file against a schema */
+struct result {
+    std::string schema;
+    std::vector<finding> findings;
+};
+
+/** A finding located in a file */
+struct diagnostic {
+    std::string path;
+    std::string schema;
+    YAML::Mark mark;
+    std::string message;
+};
+
+/** The 64-bit FNV-1a hash of some file contents */
+inline std::uint64_t content_hash(std::string_view contents)
+{
+    std::uint64_t hash = 0xcbf29ce484222325u;
+    for (char const c : contents) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 0x100000001b3u;
+    }
+    return hash;
+}
+
+/**
+ * \brief Match a generic path against a glob
+ *
+ * \param glob  `*` and `?` match within a path component, `**` across them
+ * \param path  a relative path using `/` as a separator
+ */
+inline bool glob_match(std::string_view glob, std::string_view path)
+{
+    if (glob.empty()) {
+        return path.empty();
+    }
+    if (glob.starts_with("**")) {
+        glob.remove_prefix(2);
+        // "**/" can also match no directories at all
+        if (glob.starts_with('/') and glob_match(glob.substr(1), path)) {
+            return true;
+        }
+        for (std::size_t i = 0; i <= path.size(); ++i) {
+            if (glob_match(glob, path.substr(i))) {
+                return true;
+            }
+        }
+        return false;
+    }
+    if (glob.front() == '*') {
+        for (std::size_t i = 0; i <= path.size(); ++i) {
+            if (glob_match(glob.substr(1), path.substr(i))) {
+                return true;
+            }
+            if (i < path.size() and path[i] == '/') {
+                return false;
+            }
+        }
+        return false;
+    }
+    if (path.empty()) {
+        return false;
+    }
+    if (glob.front() == '?' ? path.front() == '/'
+                            : glob.front() != path.front()) {
+        return false;
+    }
+    return glob_match(glob.substr(1), path.substr(1));
+}
+
+/**
+ * \brief The content hash of the running executable
+ *
+ * Identifies the build of the readers, so that a rebuilt linter doesn't reuse
+ * results cached by an older one.
+ *
+ * \param argv0   the program path, read if `/proc/self/exe` isn't available
+ * \return the hash, or 0 if the executable couldn't be read
+ */
+inline std::uint64_t executable_hash(char const * argv0)
+{
+    std::ifstream file{ "/proc/self/exe", std::ios::binary };
+    if (not file) {
+        file.open(argv0, std::ios::binary);
+    }
+    std::stringstream contents;
+    if (not (file and contents << file.rdbuf())) {
+        return 0u;
+    }
+    return content_hash(contents.str());
+}
+
+/**
+ * \brief Path to result cache, stored as a line-based text file
+ *
+ * Each file keeps only its latest result, along with the content hash and
+ * schema name it was found for. The file also records a fingerprint of the
+ * build that wrote it, and a cache written by a different build is discarded
+ * when loaded.
+ */
+class cache {
+public:
+    /**
+     * \brief Load a cache file, if it exists and is readable
+     * \param fingerprint   identifies the current build
+     */
+    void load(std::filesystem::path const & path, std::uint64_t fingerprint)
+    {
+        std::ifstream file{ path };
+        std::string header;
+        if (not std::getline(file, header) or
+            header != make_header(fingerprint)) {
+            return;
+        }
+        std::string line;
+        while (std::getline(file, line)) {
+            std::istringstream entry{ line };
+            std::uint64_t hash = 0u;
+            std::size_t num_findings = 0u;
+            entry >> std::hex >> hash >> std::dec >> num_findings;
+
+            std::string file_path;
+            std::string schema;
+            if (not std::getline(file, file_path) or
+                not std::getline(file, schema)) {
+                return;
+            }
+            result cached{ unescape(schema), {} };
+            for (std::size_t i = 0; i < num_findings; ++i) {
+                if (not std::getline(file, line)) {
+                    return;
+                }
+                std::istringstream stored{ line };
+                finding found;
+                std::string message;
+                stored >> found.mark.pos >> found.mark.line
+                       >> found.mark.column >> std::ws;
+                std::getline(stored, message);
+                found.message = unescape(message);
+                cached.findings.push_back(std::move(found));
+            }
+            store(unescape(file_path), hash, std::move(cached));
+        }
+    }
+
+    /**
+     * \brief Write every entry to a cache file, replacing it
+     *
+     * The entries are first written to a uniquely named temporary file, so
+     * that concurrent runs sharing a cache don't write into the same file.
+     *
+     * \param fingerprint   identifies the current build
+     */
+    void save(std::filesystem::path const & path,
+              std::uint64_t fingerprint) const
+    {
+        std::ostringstream suffix;
+        suffix << ".tmp." << std::hex << std::random_device{}()
+               << std::this_thread::get_id();
+        auto temporary = path;
+        temporary += suffix.str();
+        {
+            std::ofstream file{ temporary };
+            file << make_header(fingerprint) << "\n";
+            for (auto const & [file_path, cached] : entries) {
+                file << std::hex << cached.hash << std::dec << " "
+                     << cached.checked.findings.size() << "\n"
+                     << escape(file_path) << "\n"
+                     << escape(cached.checked.schema) << "\n";
+                for (finding const & found : cached.checked.findings) {
+                    file << found.mark.pos << " " << found.mark.line << " "
+                         << found.mark.column << " " << escape(found.message)
+                         << "\n";
+                }
+            }
+        }
+        std::error_code error;
+        std::filesystem::rename(temporary, path, error);
+        if (error) {
+            std::filesystem::remove(temporary, error);
+        }
+    }
+
+    /**
+     * \brief The cached result for a file
+     * \return the result, or nullptr if the file was last validated with
+     *         different contents or against a different schema
+     */
+    result const * find(std::string const & path, std::uint64_t hash,
+                        std::string const & schema) const
+    {
+        auto const search = entries.find(path);
+        if (search == entries.end() or search->second.hash != hash or
+            search->second.checked.schema != schema) {
+            return nullptr;
+        }
+        return &search->second.checked;
+    }
+
+    /** Add or replace the result for a file */
+    void store(std::string path, std::uint64_t hash, result validated)
+    {
+        entries.insert_or_assign(std::move(path),
+                                 entry{ hash, std::move(validated) });
+    }
+private:
+    static constexpr std::string_view magic = "konbu-lint-cache 3";
+
+    static std::string make_header(std::uint64_t fingerprint)
+    {
+        std::ostringstream header;
+        header << magic << " " << std::hex << fingerprint;
+        return header.str();
+    }
+
+    /** The latest result for a file, and the content hash it was found for */
+    struct entry {
+        std::uint64_t hash;
+        result checked;
+    };
+
+    static std::string escape(std::string_view text)
+    {
+        std::string escaped;
+        for (char const c : text) {
+            if (c == '\\') {
+                escaped += "\\\\";
+            }
+            else if (c == '\n') {
+                escaped += "\\n";
+            }
+            else {
+                escaped += c;
+            }
+        }
+        return escaped;
+    }
+    static std::string unescape(std::string_view text)
+    {
+        std::string unescaped;
+        for (std::size_t i = 0; i < text.size(); ++i) {
+            if (text[i] != '\\' or i + 1 == text.size()) {
+                unescaped += text[i];
+                continue;
+            }
+            unescaped += text[++i] == 'n' ? '\n' : text[i];
+        }
+        return unescaped;
+    }
+
+    std::unordered_map<std::string, entry> entries;
+};
+
+/** Options for a lint run */
+struct options {
+    std::vector<std::filesystem::path> roots;
+    std::optional<std::filesystem::path> cache_path = ".konbu-lint-cache";
+    std::uint64_t fingerprint = 0u; /** identifies the build in the cache */
+    std::size_t num_jobs = std::max(std::thread::hardware_concurrency(), 1u);
+};
+
+/** Statistics from a lint run */
+struct summary {
+    std::size_t num_files = 0u;
+    std::size_t num_cached = 0u;
+    std::vector<diagnostic> diagnostics;
+    std::vector<diagnostic> unsearchable; /** roots that couldn't be walked */
+};
+
+/** Validates asset trees against registered schemas */
+class linter {
+public:
+    /** Reads a document and writes any errors */
+    using validator = std::function<void(YAML::Node const &, error_list &)>;
+
+    /** A schema registered against a path glob */
+    struct schema {
+        std::string name;
+        std::string glob;
+        validator validate;
+    };
+
+    /**
+     * \brief Validate files matching a glob by reading them as `value`
+     *
+     * \tparam value    a default-constructible, konbu-readable type
+     *
+     * \param name  identifies the schema in diagnostics and the cache
+     * \param glob  paths to validate, relative to the current directory, e.g.
+     *              "**.yaml" for yaml files in any directory
+     */
+    template<std::default_initializable value>
+    requires readable<value>
+    void add_schema(std::string name, std::string glob)
+    {
+        auto validate = [](YAML::Node const & document, error_list & errors) {
+            value read_value;
+            read(document, read_value, errors);
+        };
+        schemas.push_back({ std::move(name), std::move(glob), validate });
+    }
+
+    /** The first schema whose glob matches a path, if any */
+    schema const * find_schema(std::string_view path) const
+    {
+        for (schema const & candidate : schemas) {
+            if (glob_match(candidate.glob, path)) {
+                return &candidate;
+            }
+        }
+        return nullptr;
+    }
+
+    /**
+     * \brief Validate every file under the roots that matches a schema
+     *
+     * Whether a root is a file or a directory to search, each file is named by
+     * its path relative to the current directory. That name is matched against
+     * the schema globs, reported in diagnostics and used as the cache key.
+     */
+    summary run(options const & settings) const
+    {
+        namespace fs = std::filesystem;
+        struct task {
+            fs::path path;
+            std::string name;
+            schema const * matched;
+        };
+        std::error_code no_base;
+        fs::path const base = fs::current_path(no_base);
+        auto relative_name = [&base](fs::path const & path) {
+            fs::path const absolute = path.is_absolute() ? path : base / path;
+            return absolute.lexically_normal().lexically_relative(base)
+                           .generic_string();
+        };
+        auto add_task = [this, &relative_name](std::vector<task> & tasks,
+                                               fs::path const & path) {
+            std::string name = relative_name(path);
+            if (auto const * matched = find_schema(name)) {
+                tasks.push_back({ path, std::move(name), matched });
+            }
+        };
+        std::vector<task> tasks;
+        summary ran;
+        for (fs::path const & root : settings.roots) {
+            std::error_code error;
+            if (fs::is_regular_file(root, error)) {
+                add_task(tasks, root);
+                continue;
+            }
+            fs::recursive_directory_iterator entries{ root, error };
+            for (; not error and entries != fs::recursive_directory_iterator{};
+                 entries.increment(error)) {
+
+                std::error_code ignored;
+                if (not entries->is_regular_file(ignored)) {
+                    continue;
+                }
+                add_task(tasks, entries->path());
+            }
+            if (error) {
+                ran.unsearchable.push_back({ root.generic_string(), {},
+                                             YAML::Mark::null_mark(),
+                                             error.message() });
+            }
+        }
+        cache results;
+        if (settings.cache_path) {
+            results.load(*settings.cache_path, settings.fingerprint);
+        }
+        // validate files in parallel, only reading from the shared cache
+        std::vector<outcome> outcomes(tasks.size());
+        std::atomic<std::size_t> next_task = 0u;
+        auto work = [&tasks, &outcomes, &results, &next_task] {
+            for (auto i = next_task++; i < tasks.size(); i = next_task++) {
+                outcomes[i] = validate(tasks[i].path, tasks[i].name,
+                                       *tasks[i].matched, results);
+            }
+        };
+        {
+            auto const num_workers = std::clamp<std::size_t>(
+                settings.num_jobs, 1u, std::max<std::size_t>(tasks.size(), 1u));
+            std::vector<std::jthread> workers;
+            for (std::size_t i = 0; i < num_workers; ++i) {
+                workers.emplace_back(work);
+            }
+        }
+        // replace the cached result of each file validated in this run, and
+        // keep the results of files outside of this run's roots
+        ran.num_files = tasks.size();
+        for (std::size_t i = 0; i < tasks.size(); ++i) {
+            outcome & validated = outcomes[i];
+            ran.num_cached += validated.cached ? 1u : 0u;
+            for (finding const & found : validated.checked.findings) {
+                ran.diagnostics.push_back({ tasks[i].name,
+                                            validated.checked.schema,
+                                            found.mark, found.message });
+            }
+            if (validated.cacheable) {
+                results.store(tasks[i].name, validated.hash,
+                              std::move(validated.checked));
+            }
+        }
+        if (settings.cache_path) {
+            results.save(*settings.cache_path, settings.fingerprint);
+        }
+        return ran;
+    }
+private:
+    /** The result of validating a file, and how it was found */
+    struct outcome {
+        std::uint64_t hash = 0u;
+        result checked;
+        bool cached = false;
+        bool cacheable = true;
+    };
+
+    static outcome validate(std::filesystem::path const & path,
+                            std::string const & name,
+                            schema const & matched,
+                            cache const & results)
+    {
+        outcome validated{ .checked = { matched.name, {} } };
+
+        std::ifstream file{ path, std::ios::binary };
+        std::stringstream contents;
+        if (not (file and contents << file.rdbuf())) {
+            validated.checked.findings.push_back({ YAML::Mark::null_mark(),
+                                                   "couldn't read file" });
+            validated.cacheable = false;
+            return validated;
+        }
+        std::string const text = contents.str();
+        validated.hash = content_hash(text);
+        if (auto const * cached = results.find(name, validated.hash,
+                                               matched.name)) {
+            validated.checked = *cached;
+            validated.cached = true;
+            return validated;
+        }
+        error_list errors;
+        try {
+            matched.validate(YAML::Load(text), errors);
+        }
+        catch (YAML::Exception const & error) {
+            errors.push_back(error);
+        }
+        // a reader failing in some other way may not fail the same way again
+        catch (std::exception const & error) {
+            errors.push_back({ YAML::Mark::null_mark(), error.what() });
+            validated.cacheable = false;
+        }
+        for (YAML::Exception const & error : errors) {
+            validated.checked.findings.push_back({ error.mark, error.msg });
+        }
+        return validated;
+    }
+
+    std::vector<schema> schemas;
+};
+
+/** Write a string as a quoted json string */
+inline void write_json_string(std::ostream & output, std::string_view text)
+{
+    output << '"';
+    for (char const c : text) {
+        switch (c) {
+        case '"':  output << "\\\""; break;
+        case '\\': output << "\\\\"; break;
+        case '\n': output << "\\n"; break;
+        case '\t': output << "\\t"; break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20u) {
+                output << "\\u00" << "0123456789abcdef"[(c >> 4) & 0xf]
+                       << "0123456789abcdef"[c & 0xf];
+            }
+            else {
+                output << c;
+            }
+        }
+    }
+    output << '"';
+}
+
+/**
+ * \brief Write a message on a single line
+ *
+ * Each line break, along with the indentation following it, is replaced by a
+ * single space.
+ */
+inline void write_single_line(std::ostream & output, std::string_view text)
+{
+    for (std::size_t i = 0; i < text.size(); ++i) {
+        if (text[i] != '\n') {
+            output << text[i];
+            continue;
+        }
+        while (i + 1 < text.size() and (text[i + 1] == ' ' or
+                                        text[i + 1] == '\t' or
+                                        text[i + 1] == '\n')) {
+            ++i;
+        }
+        if (i + 1 < text.size()) {
+            output << ' ';
+        }
+    }
+}
+
+/**
+ * \brief Run a linter from the command line
+ *
+ * usage: konbu-lint [--jobs <n>] [--cache <file> | --no-cache]
+ *                   [--format json|gnu] <path>...
+ *
+ * Diagnostics are written to stdout, one per line: either as json objects, or
+ * as gnu-style "path:line:column: error: message" lines. Lines and columns
+ * start at 1, and are 0 when an error has no position. Cached results are tied
+ * to the hash of the running executable.
+ *
+ * \return 0 if every file is valid, 1 if there were diagnostics, or 2 if the
+ *         arguments were invalid or a path couldn't be searched
+ */
+inline int run_command_line(linter const & lint, int argc, char * argv[])
+{
+    options settings;
+    bool json = true;
+    auto usage = [] {
+        std::cerr << "usage: konbu-lint [--jobs <n>] "
+                     "[--cache <file> | --no-cache] "
+                     "[--format json|gnu] <path>...\n";
+        return 2;
+    };
+    for (int i = 1; i < argc; ++i) {
+        std::string_view const arg = argv[i];
+        bool const has_value = i + 1 < argc;
+        if (arg == "--jobs" and has_value) {
+            std::string_view const jobs = argv[++i];
+            auto const [end, error] = std::from_chars(
+                jobs.data(), jobs.data() + jobs.size(), settings.num_jobs);
+            if (error != std::errc{} or end != jobs.data() + jobs.size() or
+                settings.num_jobs == 0u) {
+                return usage();
+            }
+        }
+        else if (arg == "--cache" and has_value) {
+            settings.cache_path = argv[++i];
+        }
+        else if (arg == "--no-cache") {
+            settings.cache_path.reset();
+        }
+        else if (arg == "--format" and has_value) {
+            std::string_view const format = argv[++i];
+            if (format != "json" and format != "gnu") {
+                return usage();
+            }
+            json = format == "json";
+        }
+        else if (arg.starts_with("--")) {
+            return usage();
+        }
+        else {
+            settings.roots.emplace_back(arg);
+        }
+    }
+    if (settings.roots.empty()) {
+        return usage();
+    }
+    settings.fingerprint = executable_hash(argv[0]);
+    summary const ran = lint.run(settings);
+    for (diagnostic const & found : ran.diagnostics) {
+        int const line = found.mark.is_null() ? 0 : found.mark.line + 1;
+        int const column = found.mark.is_null() ? 0 : found.mark.column + 1;
+        if (not json) {
+            std::cout << found.path << ":" << line << ":" << column
+                      << ": error: ";
+            write_single_line(std::cout, found.message);
+            std::cout << "\n";
+            continue;
+        }
+        std::cout << "{\"path\":";
+        write_json_string(std::cout, found.path);
+        std::cout << ",\"schema\":";
+        write_json_string(std::cout, found.schema);
+        std::cout << ",\"line\":" << line << ",\"column\":" << column
+                  << ",\"message\":";
+        write_json_string(std::cout, found.message);
+        std::cout << "}\n";
+    }
+    for (diagnostic const & failed : ran.unsearchable) {
+        std::cerr << "konbu-lint: " << failed.path << ": " << failed.message
+                  << "\n";
+    }
+    std::cerr << "konbu-lint: checked " << ran.num_files << " files ("
+              << ran.num_cached << " cached), found "
+              << ran.diagnostics.size() << " errors\n";
+    if (not ran.unsearchable.empty()) {
+        return 2;
+    }
+    return ran.diagnostics.empty() ? 0 : 1;
+}
+}
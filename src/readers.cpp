@@ -0,0 +1,7 @@
+#include "konbu/konbu.h"
+#include "konbu/frozen.h"
+
+namespace konbu {
+KONBU_CORE_READERS(template, YAML::Node)
+KONBU_CORE_READERS(template, frozen_node)
+}